@@ -3,6 +3,14 @@
 #include "errors.h"
 #include <math.h>
 #include <unistd.h>
+#ifdef DEBUG
+#include <sys/resource.h>
+#endif
+#ifdef __linux__
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <stdint.h>
+#endif
 
 #define ALARM_ARRAY_SIZE 128 // Define a constant for the maximum size of alarm messages and categories.
 // Based on assignment requirement to keep message to 128 character
@@ -17,6 +25,7 @@ typedef struct alarm_struct
     char message[ALARM_ARRAY_SIZE];        // Message associated with the alarm.
     int alarm_time_group_number;           // Group number of the alarm based on its time.
     time_t next_display_time;              // Time for next display of the alarm message.
+    int heap_index;                        // Position of the alarm in the event loop's deadline heap.
 } alarm_t;
 
 // Structure definition for display alarm threads.
@@ -35,6 +44,38 @@ pthread_mutex_t display_thread_mutex = PTHREAD_MUTEX_INITIALIZER;
 alarm_t *alarm_list = NULL;
 display_thread_t *display_thread_list = NULL;
 
+/*
+ * Measurement probes for comparing the two engines. When compiled -DDEBUG,
+ * they report fire latency and resource usage. Otherwise they expand to
+ * nothing, so a normal build does no extra work inside the display threads.
+ */
+#ifdef DEBUG
+// Print how late an alarm fired relative to its scheduled display time.
+void report_fire_latency(alarm_t *alarm)
+{
+    struct timespec fired;
+
+    clock_gettime(CLOCK_REALTIME, &fired);
+    printf("Alarm(%d) fired %ld ms after its deadline\n", alarm->alarm_id,
+           (long)(fired.tv_sec - alarm->next_display_time) * 1000 + fired.tv_nsec / 1000000);
+}
+
+// Print the resource usage of the process on exit.
+void report_usage(const char *engine)
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        printf("%s engine: max RSS %ld KB, %ld voluntary / %ld involuntary context switches\n",
+               engine, usage.ru_maxrss, usage.ru_nvcsw, usage.ru_nivcsw);
+    }
+}
+#else
+# define report_fire_latency(alarm)
+# define report_usage(engine)
+#endif
+
 // Thread function for display alarm threads.
 void *display_alarm_thread(void *arg)
 {
@@ -53,6 +94,7 @@ void *display_alarm_thread(void *arg)
             {
                 if (now >= current->next_display_time)
                 {
+                    report_fire_latency(current);
                     printf("Alarm (%d) Printed by Alarm Thread %lu for Alarm_Time_Group_Number %d at %ld: %d %s\n",
                            current->alarm_id, (unsigned long)pthread_self(), time_group_number, now, current->seconds, current->message);
                     current->next_display_time = now + current->seconds; // Set the next display time.
@@ -73,6 +115,121 @@ int get_group_number(int time)
     return (int)ceil((double)time / 5.0); // Calculate and return the ceiling of time divided by 5.
 }
 
+// Commands accepted at the alarm> prompt.
+typedef enum
+{
+    COMMAND_START_ALARM,
+    COMMAND_REPLACE_ALARM,
+    COMMAND_CANCEL_ALARM,
+    COMMAND_BAD
+} command_t;
+
+// Function to parse a command line. Start_Alarm and Replace_Alarm fill in alarm, Cancel_Alarm fills in alarm_id.
+command_t parse_command(char *line, alarm_t *alarm, int *alarm_id)
+{
+    // Truncate input line if it's over 128 characters long
+    if (strlen(line) > 127)
+    {
+        line[127] = '\0'; // Ensure the line ends with a null character.
+    }
+
+    if (sscanf(line, "Start_Alarm(%d): %d %63[^\n]", &alarm->alarm_id, &alarm->seconds, alarm->message) == 3)
+    {
+        return COMMAND_START_ALARM;
+    }
+    if (sscanf(line, "Replace_Alarm(%d): %d %63[^\n]", &alarm->alarm_id, &alarm->seconds, alarm->message) == 3)
+    {
+        return COMMAND_REPLACE_ALARM;
+    }
+    if (sscanf(line, "Cancel_Alarm(%d)", alarm_id) == 1)
+    {
+        return COMMAND_CANCEL_ALARM;
+    }
+
+    // The input line does not match the format for starting, replacing, or canceling an alarm.
+    fprintf(stderr, "Bad command or format. Discarded: %s", line);
+    return COMMAND_BAD;
+}
+
+// Function to insert a new alarm into the alarm list. The threaded engine must hold alarm_mutex.
+void insert_alarm(alarm_t *alarm, pthread_t main_thread_id)
+{
+    alarm_t **last, *next; // Pointers for managing alarms in a linked list.
+
+    // Calculate the alarm time (current time plus the specified seconds).
+    // This determines when the alarm should trigger.
+    alarm->time = time(NULL) + alarm->seconds;
+    alarm->next_display_time = alarm->time; // Set the next display time to the alarm time initially.
+
+    // Calculate the alarm's group number based on its time,
+    // grouping alarms into buckets of 5 seconds each.
+    alarm->alarm_time_group_number = get_group_number(alarm->seconds);
+
+    // Insert the new alarm into the alarm list in sorted order by ID.
+    for (last = &alarm_list; (next = *last) != NULL; last = &next->link)
+    {
+        if (next->alarm_id >= alarm->alarm_id)
+        {
+            break;
+        }
+    }
+    alarm->link = next;
+    *last = alarm;
+
+    // Print a confirmation message indicating successful insertion.
+    printf("Alarm(%d) Inserted by Main Thread %lu Into Alarm List at %ld: %d %s\n",
+           alarm->alarm_id, (unsigned long)main_thread_id, alarm->time, alarm->seconds, alarm->message);
+}
+
+// Function to apply a Replace_Alarm request to the alarm list. The threaded engine must hold alarm_mutex.
+// Returns the replaced alarm and its previous group number, or NULL if no alarm has the requested ID.
+alarm_t *replace_alarm(alarm_t *request, time_t now, int *old_group_number)
+{
+    alarm_t *next;
+
+    for (next = alarm_list; next != NULL; next = next->link)
+    {
+        if (next->alarm_id == request->alarm_id)
+        {
+            *old_group_number = next->alarm_time_group_number;                   // Store old group number for later use.
+            next->alarm_time_group_number = get_group_number(request->seconds);  // Recalculate the group number.
+            next->seconds = request->seconds;                                    // Update the seconds.
+            next->time = now + request->seconds;                                 // Update the alarm time.
+            next->next_display_time = next->time;                                // Update the next display time.
+            strncpy(next->message, request->message, sizeof(next->message) - 1); // Copy the new message.
+            next->message[sizeof(next->message) - 1] = '\0';                     // Ensure null termination.
+
+            // Print confirmation that the alarm has been replaced.
+            printf("Alarm(%d) Replaced at %ld: %d %s\n",
+                   request->alarm_id, now, request->seconds, request->message);
+            return next;
+        }
+    }
+
+    fprintf(stderr, "Replace_Alarm: No alarm found with ID %d.\n", request->alarm_id);
+    return NULL;
+}
+
+// Function to unlink a cancelled alarm from the alarm list. The threaded engine must hold alarm_mutex.
+// Returns the unlinked alarm for the caller to free, or NULL if no alarm has the requested ID.
+alarm_t *remove_alarm(int alarm_id, time_t now)
+{
+    alarm_t **last, *next;
+
+    for (last = &alarm_list; (next = *last) != NULL; last = &next->link)
+    {
+        if (next->alarm_id == alarm_id)
+        {
+            *last = next->link; // Remove the alarm from the list.
+            printf("Alarm(%d) Canceled at %ld: %d %s\n", alarm_id, now, next->seconds, next->message);
+            return next;
+        }
+    }
+
+    fprintf(stderr, "Cancel_Alarm: No alarm found with ID %d.\n", alarm_id);
+    return NULL;
+}
+
 // Function to manage the creation and addition of display threads.
 void manage_display_threads(int group_number, int alarm_id, time_t now) {
     int status; // For storing return values of various functions, particularly pthread functions.
@@ -188,25 +345,366 @@ void terminate_display_thread_if_empty(int group_number, time_t now) {
             prev_thread = current_thread; // Update the previous thread pointer.
             current_thread = current_thread -> next; // Move to the next thread in the list.
         }
+    }
 
-        status = pthread_mutex_unlock( & display_thread_mutex); // Unlock the display thread list mutex.
-        if (status != 0) {
-            err_abort(status, "Unlock mutex");
+    // Unlock both mutexes whether or not the group was empty.
+    status = pthread_mutex_unlock( & display_thread_mutex); // Unlock the display thread list mutex.
+    if (status != 0) {
+        err_abort(status, "Unlock mutex");
+    }
+
+    status = pthread_mutex_unlock( & alarm_mutex); // Unlock the alarm list mutex.
+    if (status != 0) {
+        err_abort(status, "Unlock mutex");
+    }
+}
+
+#ifdef __linux__
+/*
+ * Single-threaded event loop engine, selected with "-e".
+ *
+ * Instead of one display thread per Alarm_Time_Group_Number polling once a
+ * second, a single loop polls stdin together with one timerfd armed for the
+ * earliest display time. Due alarms are taken from a min-heap ordered by
+ * next_display_time. Only the main thread touches the alarm list, so no
+ * mutexes are needed. Groups are kept as logical records, and their group
+ * number is printed where the threaded engine prints a display thread ID.
+ */
+
+// Structure definition for a logical display group in the event loop engine.
+typedef struct event_group_struct
+{
+    int time_group_number;            // Group number the record stands for.
+    struct event_group_struct *next;  // Pointer to the next group in the list.
+} event_group_t;
+
+event_group_t *event_group_list = NULL;
+alarm_t **alarm_heap = NULL; // Min-heap of alarms keyed by next_display_time.
+int alarm_heap_size = 0;
+int alarm_heap_capacity = 0;
+
+// Return nonzero if alarm a should be displayed before alarm b.
+int alarm_heap_before(alarm_t *a, alarm_t *b)
+{
+    if (a->next_display_time != b->next_display_time)
+    {
+        return a->next_display_time < b->next_display_time;
+    }
+    return a->alarm_id < b->alarm_id;
+}
+
+// Place an alarm at the given heap slot and record its position.
+void alarm_heap_set(int index, alarm_t *alarm)
+{
+    alarm_heap[index] = alarm;
+    alarm->heap_index = index;
+}
+
+// Restore the heap order around the given slot after its key changed.
+void alarm_heap_fix(int index)
+{
+    alarm_t *alarm = alarm_heap[index];
+
+    // Move the alarm up while it is due before its parent.
+    while (index > 0 && alarm_heap_before(alarm, alarm_heap[(index - 1) / 2]))
+    {
+        alarm_heap_set(index, alarm_heap[(index - 1) / 2]);
+        index = (index - 1) / 2;
+    }
+
+    // Move the alarm down while one of its children is due before it.
+    while (1)
+    {
+        int child = 2 * index + 1;
+        if (child >= alarm_heap_size)
+        {
+            break;
+        }
+        if (child + 1 < alarm_heap_size && alarm_heap_before(alarm_heap[child + 1], alarm_heap[child]))
+        {
+            child++;
+        }
+        if (!alarm_heap_before(alarm_heap[child], alarm))
+        {
+            break;
         }
+        alarm_heap_set(index, alarm_heap[child]);
+        index = child;
+    }
+    alarm_heap_set(index, alarm);
+}
 
-        status = pthread_mutex_unlock( & alarm_mutex); // Unlock the alarm list mutex.
-        if (status != 0) {
-            err_abort(status, "Unlock mutex");
+// Add an alarm to the heap.
+void alarm_heap_push(alarm_t *alarm)
+{
+    if (alarm_heap_size == alarm_heap_capacity)
+    {
+        alarm_heap_capacity = alarm_heap_capacity ? alarm_heap_capacity * 2 : 16;
+        alarm_heap = (alarm_t **)realloc(alarm_heap, alarm_heap_capacity * sizeof(alarm_t *));
+        if (alarm_heap == NULL)
+        {
+            errno_abort("Allocate alarm heap");
+        }
+    }
+    alarm_heap_set(alarm_heap_size++, alarm);
+    alarm_heap_fix(alarm->heap_index);
+}
+
+// Remove an alarm from any position in the heap.
+void alarm_heap_remove(alarm_t *alarm)
+{
+    int index = alarm->heap_index;
+
+    alarm_heap_size--;
+    if (index != alarm_heap_size)
+    {
+        alarm_heap_set(index, alarm_heap[alarm_heap_size]);
+        alarm_heap_fix(index);
+    }
+}
+
+// Create the logical group for an alarm if it does not exist yet (event loop counterpart of manage_display_threads).
+void event_manage_group(alarm_t *alarm, time_t now)
+{
+    event_group_t *group;
+
+    for (group = event_group_list; group != NULL; group = group->next)
+    {
+        if (group->time_group_number == alarm->alarm_time_group_number)
+        {
+            return;
+        }
+    }
+
+    group = (event_group_t *)malloc(sizeof(event_group_t));
+    if (group == NULL)
+    {
+        errno_abort("Allocate event group");
+    }
+    group->time_group_number = alarm->alarm_time_group_number;
+    group->next = event_group_list;
+    event_group_list = group;
+
+    printf("Created New Display Alarm Thread %d for Alarm_Time_Group_Number %d to Display Alarm(%d) at %ld: %d %s\n",
+           group->time_group_number, group->time_group_number, alarm->alarm_id, now, alarm->seconds, alarm->message);
+}
+
+// Drop the logical group if no alarm belongs to it any more (event loop counterpart of terminate_display_thread_if_empty).
+void event_terminate_group_if_empty(int group_number, time_t now)
+{
+    event_group_t *group, **last;
+    alarm_t *current;
+
+    for (current = alarm_list; current != NULL; current = current->link)
+    {
+        if (current->alarm_time_group_number == group_number)
+        {
+            return;
+        }
+    }
+
+    for (last = &event_group_list; (group = *last) != NULL; last = &group->next)
+    {
+        if (group->time_group_number == group_number)
+        {
+            printf("Display Alarm Thread %d for Alarm_Time_Group_Number %d Terminated at %ld\n",
+                   group_number, group_number, now);
+            *last = group->next;
+            free(group);
+            break;
+        }
+    }
+}
+
+// Print every alarm whose display time has come and schedule its next display.
+void event_fire_due_alarms(void)
+{
+    time_t now = time(NULL);
+
+    while (alarm_heap_size > 0 && alarm_heap[0]->next_display_time <= now)
+    {
+        alarm_t *current = alarm_heap[0];
+
+        report_fire_latency(current);
+        printf("Alarm (%d) Printed by Alarm Thread %d for Alarm_Time_Group_Number %d at %ld: %d %s\n",
+               current->alarm_id, current->alarm_time_group_number, current->alarm_time_group_number,
+               now, current->seconds, current->message);
+
+        // A display thread re-checks at least once a second, so never schedule sooner than that.
+        current->next_display_time = now + (current->seconds > 0 ? current->seconds : 1);
+        alarm_heap_fix(0);
+    }
+}
+
+// Arm the timer for the earliest display time, or disarm it when no alarms remain.
+void event_arm_timer(int timer_fd)
+{
+    struct itimerspec spec;
+
+    memset(&spec, 0, sizeof(spec));
+    if (alarm_heap_size > 0)
+    {
+        spec.it_value.tv_sec = alarm_heap[0]->next_display_time;
+    }
+    if (timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) == -1)
+    {
+        errno_abort("Arm timer");
+    }
+}
+
+// Parse and execute one command line in the event loop engine.
+void event_process_line(char *line, pthread_t main_thread_id)
+{
+    alarm_t *alarm, *current;
+    int user_alarm_id;
+
+    // Skip processing if the input line is empty or only contains a newline character
+    if (strlen(line) <= 1)
+    {
+        return;
+    }
+
+    alarm = (alarm_t *)malloc(sizeof(alarm_t));
+    if (alarm == NULL)
+    {
+        errno_abort("Allocate alarm");
+    }
+
+    switch (parse_command(line, alarm, &user_alarm_id))
+    {
+    case COMMAND_START_ALARM:
+        insert_alarm(alarm, main_thread_id);
+        alarm_heap_push(alarm);
+        event_manage_group(alarm, alarm->time);
+        return; // The alarm is now owned by the alarm list.
+    case COMMAND_REPLACE_ALARM:
+    {
+        time_t now = time(NULL);
+        int old_group_number;
+
+        current = replace_alarm(alarm, now, &old_group_number);
+        if (current != NULL)
+        {
+            alarm_heap_fix(current->heap_index);
+            event_manage_group(current, now);
+            event_terminate_group_if_empty(old_group_number, now);
+        }
+        break;
+    }
+    case COMMAND_CANCEL_ALARM:
+    {
+        time_t cancel_time = time(NULL);
+
+        current = remove_alarm(user_alarm_id, cancel_time);
+        if (current != NULL)
+        {
+            int group_number = current->alarm_time_group_number;
+
+            alarm_heap_remove(current);
+            free(current);
+            event_terminate_group_if_empty(group_number, cancel_time);
         }
+        break;
     }
+    case COMMAND_BAD:
+        break;
+    }
+    free(alarm);
 }
 
+// Main loop of the event loop engine: wait on stdin and the timer, and handle whichever is ready.
+int run_event_loop(void)
+{
+    char line[ALARM_ARRAY_SIZE]; // Line being assembled from stdin, limited like the threaded engine.
+    int line_length = 0;
+    char input[4096];            // Raw bytes read from stdin.
+    pthread_t main_thread_id = pthread_self();
+    struct pollfd fds[2];        // poll() rather than epoll, since epoll rejects stdin redirected from a regular file.
+    int timer_fd;
+
+    timer_fd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK);
+    if (timer_fd == -1)
+    {
+        errno_abort("Create timer");
+    }
+
+    fds[0].fd = STDIN_FILENO;
+    fds[0].events = POLLIN;
+    fds[1].fd = timer_fd;
+    fds[1].events = POLLIN;
+
+    printf("alarm> ");
+    fflush(stdout);
+
+    while (1)
+    {
+        if (poll(fds, 2, -1) == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            errno_abort("Wait for events");
+        }
+
+        if (fds[1].revents & POLLIN)
+        {
+            uint64_t expirations;
+            if (read(timer_fd, &expirations, sizeof(expirations)) == -1 && errno != EAGAIN)
+            {
+                errno_abort("Read timer");
+            }
+        }
+        if (fds[0].revents & (POLLIN | POLLHUP))
+        {
+            ssize_t bytes = read(STDIN_FILENO, input, sizeof(input));
+            ssize_t j;
+
+            if (bytes == -1 && errno != EINTR && errno != EAGAIN)
+            {
+                errno_abort("Read stdin");
+            }
+            if (bytes == 0)
+            {
+                // Like fgets, run a last command that has no trailing newline.
+                if (line_length > 0)
+                {
+                    line[line_length] = '\0';
+                    event_process_line(line, main_thread_id);
+                }
+                report_usage("Event loop");
+                exit(0); // Exit the program if EOF is encountered.
+            }
+
+            // Split the input into lines; like fgets, a line longer than the buffer is handled in pieces.
+            for (j = 0; j < bytes; j++)
+            {
+                line[line_length++] = input[j];
+                if (input[j] == '\n' || line_length == ALARM_ARRAY_SIZE - 1)
+                {
+                    line[line_length] = '\0';
+                    line_length = 0;
+                    event_process_line(line, main_thread_id);
+                    printf("alarm> ");
+                }
+            }
+        }
+
+        event_fire_due_alarms();
+        event_arm_timer(timer_fd);
+        fflush(stdout);
+    }
+    return 0;
+}
+#endif
+
 int main(int argc, char *argv[])
 {
     // Variable declarations
     int status;                    // For storing return values of various functions, particularly pthread functions.
     char line[ALARM_ARRAY_SIZE];   // Buffer to store user input, limited by ALARM_ARRAY_SIZE.
-    alarm_t *alarm, **last, *next; // Pointers for managing alarms in a linked list.
+    alarm_t *alarm, *next;         // Pointers for managing alarms in a linked list.
+    command_t command;             // Command parsed from user input.
 
     // Store the thread ID of the main thread
     pthread_t main_thread_id = pthread_self();
@@ -214,6 +712,17 @@ int main(int argc, char *argv[])
     // Variable to store alarm ID parsed from user input for 'Cancel_Alarm' command
     int user_alarm_id;
 
+    // Run the single-threaded event loop engine instead of display threads when started with "-e".
+    if (argc > 1 && strcmp(argv[1], "-e") == 0)
+    {
+#ifdef __linux__
+        return run_event_loop();
+#else
+        fprintf(stderr, "The event loop engine requires Linux (timerfd).\n");
+        exit(1);
+#endif
+    }
+
     // Infinite loop to continuously accept and process user commands
     while (1)
     {
@@ -222,6 +731,7 @@ int main(int argc, char *argv[])
         // Read a line of input from the user and check for EOF (End Of File)
         if (fgets(line, sizeof(line), stdin) == NULL)
         {
+            report_usage("Threaded");
             exit(0);
         } // Exit the program if EOF is encountered.
 
@@ -238,16 +748,9 @@ int main(int argc, char *argv[])
             errno_abort("Allocate alarm"); // Abort if memory allocation fails.
         }
 
-        // Truncate input line if it's over 128 characters long
-        if (strlen(line) > 127)
+        command = parse_command(line, alarm, &user_alarm_id);
+        if (command == COMMAND_START_ALARM)
         {
-            line[127] = '\0'; // Ensure the line ends with a null character.
-        }
-
-        // Parse input line into command format for Start_Alarm.
-        if (sscanf(line, "Start_Alarm(%d): %d %63[^\n]", &alarm->alarm_id, &alarm->seconds, alarm->message) == 3)
-        {
-
             // Lock the mutex to ensure thread-safe access to the shared alarm list.
             // This is important to prevent concurrent access issues.
             status = pthread_mutex_lock(&alarm_mutex);
@@ -256,59 +759,22 @@ int main(int argc, char *argv[])
                 err_abort(status, "Lock mutex"); // Abort if mutex lock fails.
             }
 
-            // Calculate the alarm time (current time plus the specified seconds).
-            // This determines when the alarm should trigger.
-            alarm->time = time(NULL) + alarm->seconds;
-            alarm->next_display_time = alarm->time; // Set the next display time to the alarm time initially.
-
-            // Calculate the alarm's group number based on its time,
-            // grouping alarms into buckets of 5 seconds each.
-            alarm->alarm_time_group_number = (int)ceil((double)alarm->seconds / 5.0);
-
-            // Insert the new alarm into the alarm list in a sorted order by time.
-            last = &alarm_list; // Start at the head of the list.
-            next = *last;       // Initialize the next pointer for traversal.
-
-            // Traverse the list to find the correct insertion point.
-            while (next != NULL)
-            {
-                // If we find an alarm with a time greater or equal to the new alarm,
-                // insert the new alarm before it to maintain sorted order.
-                if (next->alarm_id >= alarm->alarm_id)
-                {
-                    alarm->link = next; // Point new alarm to the next one in the list.
-                    *last = alarm;      // Insert the new alarm into the list.
-                    break;              // Break as we have inserted the alarm.
-                }
-                // Move to the next alarm in the list.
-                last = &next->link;
-                next = next->link;
-            }
-
-            // If we reached the end of the list, append the new alarm at the end.
-            if (next == NULL)
-            {
-                *last = alarm;      // Set the last alarm's link to the new alarm.
-                alarm->link = NULL; // The new alarm is now the last one, so its link is NULL.
-            }
+            insert_alarm(alarm, main_thread_id);
 
             // Unlock the alarm list mutex so that manage_display_threads can access the alarm list.
-            pthread_mutex_unlock( & alarm_mutex); // Unlock the alarm list mutex.
-            if (status != 0) {
+            status = pthread_mutex_unlock(&alarm_mutex);
+            if (status != 0)
+            {
                 err_abort(status, "Unlock mutex");
             }
 
-            // Print a confirmation message indicating successful insertion.
-            printf("Alarm(%d) Inserted by Main Thread %lu Into Alarm List at %ld: %d %s\n",
-                   alarm->alarm_id, (unsigned long)main_thread_id, alarm->time, alarm->seconds, alarm->message);
-
             // After inserting the alarm into the list, manage display threads for this group number
             manage_display_threads(alarm->alarm_time_group_number, alarm->alarm_id, alarm->time);
         }
-        else if (sscanf(line, "Replace_Alarm(%d): %d %63[^\n]", &alarm->alarm_id, &alarm->seconds, alarm->message) == 3)
+        else if (command == COMMAND_REPLACE_ALARM)
         {
-            int found = 0;           // Flag to check if the alarm is found in the list.
             time_t now = time(NULL); // Get the current time.
+            int old_group_number;    // Group number of the alarm before it was replaced.
 
             // Lock the mutex to ensure exclusive access to the alarm list.
             status = pthread_mutex_lock(&alarm_mutex);
@@ -317,59 +783,26 @@ int main(int argc, char *argv[])
                 err_abort(status, "Lock mutex");
             }
 
-            // Iterate through the alarm list to find the alarm to be replaced.
-            for (last = &alarm_list;
-                 (next = *last) != NULL; last = &next->link)
-            {
-                if (next->alarm_id == alarm->alarm_id)
-                {                                                                      // Check if the alarm IDs match.
-                    int old_group_number = next->alarm_time_group_number;              // Store old group number for later use.
-                    next->alarm_time_group_number = get_group_number(alarm->seconds);  // Recalculate the group number.
-                    next->seconds = alarm->seconds;                                    // Update the seconds.
-                    next->time = now + alarm->seconds;                                 // Update the alarm time.
-                    next->next_display_time = next->time;                              // Update the next display time.
-                    strncpy(next->message, alarm->message, sizeof(next->message) - 1); // Copy the new message.
-                    next->message[sizeof(next->message) - 1] = '\0';                   // Ensure null termination.
-                    found = 1;                                                         // Set the found flag.
-
-                    // Print confirmation that the alarm has been replaced.
-                    printf("Alarm(%d) Replaced at %ld: %d %s\n",
-                           alarm->alarm_id, now, alarm->seconds, alarm->message);
-
-                    // Unlock the alarm list mutex so that terminate_display_thread_if_empty can access the alarm list.
-                    pthread_mutex_unlock(&alarm_mutex); // Unlock the alarm list mutex.
-                    if (status != 0)
-                    {
-                        err_abort(status, "Unlock mutex");
-                    }
-
-                    // Manage display threads for the new group number and check if old threads need to be terminated.
-                    manage_display_threads(next->alarm_time_group_number, alarm->alarm_id, now);
-                    terminate_display_thread_if_empty(old_group_number, now);
-                    break; // Break the loop as the alarm has been found and replaced.
-                }
-            }
+            next = replace_alarm(alarm, now, &old_group_number);
 
-            // Unlock the mutex after modifications.
-            // status = pthread_mutex_unlock( & alarm_mutex);
-            /*
-            if (status != 0){
+            // Unlock the alarm list mutex so that terminate_display_thread_if_empty can access the alarm list.
+            status = pthread_mutex_unlock(&alarm_mutex);
+            if (status != 0)
+            {
                 err_abort(status, "Unlock mutex");
             }
-            */
 
-            // If the alarm ID was not found in the list, print an error message.
-            if (!found)
+            if (next != NULL)
             {
-                fprintf(stderr, "Replace_Alarm: No alarm found with ID %d.\n", alarm->alarm_id);
+                // Manage display threads for the new group number and check if old threads need to be terminated.
+                manage_display_threads(next->alarm_time_group_number, alarm->alarm_id, now);
+                terminate_display_thread_if_empty(old_group_number, now);
             }
             free(alarm); // Free the memory allocated for the alarm.
         }
-        else if (sscanf(line, "Cancel_Alarm(%d)", &user_alarm_id) == 1)
+        else if (command == COMMAND_CANCEL_ALARM)
         {
-            alarm_t *current, *prev = NULL; // Pointers to traverse and keep track of previous alarm.
-            int found = 0;                  // Flag to check if the alarm is found in the list.
-            int group_number = -1;          // To store the group number of the cancelled alarm.
+            int group_number = -1; // To store the group number of the cancelled alarm.
 
             // Lock the mutex to ensure exclusive access to the alarm list.
             status = pthread_mutex_lock(&alarm_mutex);
@@ -378,63 +811,33 @@ int main(int argc, char *argv[])
                 err_abort(status, "Lock mutex");
             }
 
-            // Iterate through the alarm list to find and remove the specified alarm.
-            current = alarm_list;
-            while (current != NULL)
+            next = remove_alarm(user_alarm_id, time(NULL));
+            if (next != NULL)
             {
-                if (current->alarm_id == user_alarm_id)
-                {                                                    // Check if the alarm IDs match.
-                    found = 1;                                       // Set the found flag.
-                    group_number = current->alarm_time_group_number; // Store the group number.
-                    if (prev == NULL)
-                    {
-                        alarm_list = current->link; // Remove the alarm from the list.
-                    }
-                    else
-                    {
-                        prev->link = current->link; // Remove the alarm from the middle or end of the list.
-                    }
-                    time_t cancel_time = time(NULL); // Get the current time for the cancellation message.
-                    printf("Alarm(%d) Canceled at %ld: %d %s\n", user_alarm_id, cancel_time, current->seconds, current->message);
-                    free(current); // Free the memory allocated for the alarm.
-                    break;         // Break the loop as the alarm has been found and cancelled.
-                }
-                prev = current;          // Update the previous pointer.
-                current = current->link; // Move to the next alarm in the list.
+                group_number = next->alarm_time_group_number; // Store the group number.
+                free(next);                                   // Free the memory allocated for the alarm.
             }
 
             // Unlock the mutex after modifications.
-            pthread_mutex_unlock(&alarm_mutex);
+            status = pthread_mutex_unlock(&alarm_mutex);
             if (status != 0)
             {
                 err_abort(status, "Unlock mutex");
             }
 
-            // If the alarm ID was not found in the list, print an error message.
-            if (found)
+            if (group_number != -1)
             {
                 // Check if any other alarm exists in the same group and manage display threads accordingly.
                 terminate_display_thread_if_empty(group_number, time(NULL));
             }
-            else
-            {
-                fprintf(stderr, "Cancel_Alarm: No alarm found with ID %d.\n", user_alarm_id);
-            }
             free(alarm); // Free the memory allocated for the alarm structure, even if not used.
         }
         else
         {
-            // This block handles the case where the user input does not match any of the expected command formats.
-            // If the input line does not match the format for starting, replacing, or canceling an alarm,
-            // it is considered a bad command or format.
-
-            // Print an error message to the standard error stream.
-            fprintf(stderr, "Bad command or format. Discarded: %s", line);
-
             // Free the memory allocated for the alarm structure.
             free(alarm);
         }
         // End of the while loop. The program will go back to the beginning of the loop and wait for new user input.
     }
     // End of the main function.
-}
\ No newline at end of file
+}